@@ -0,0 +1,222 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+#include "imgui.h"
+
+#include "draw_data_codec.hpp"
+#include "gles_device.hpp"
+#include "recording_gles_api.hpp"
+
+namespace {
+
+using RecordingGlesDevice = emgui::BasicGlesDevice<emgui::RecordingGlesApi>;
+
+class SyntheticDrawData {
+ public:
+  SyntheticDrawData(int lists_count, int cmds_per_list, int quads_per_cmd,
+                    int textures_count) {
+    for (int list = 0; list < lists_count; ++list) {
+      auto cmd_list = std::make_unique<ImDrawList>();
+      for (int cmd = 0; cmd < cmds_per_list; ++cmd) {
+        ImDrawCmd draw_cmd;
+        draw_cmd.ElemCount = quads_per_cmd * 6;
+        draw_cmd.ClipRect = ImVec4(0.0f, 0.0f, 1920.0f, 1080.0f);
+        draw_cmd.TextureId = reinterpret_cast<ImTextureID>(
+            static_cast<std::uintptr_t>(1 + cmd % textures_count));
+        cmd_list->CmdBuffer.push_back(draw_cmd);
+        for (int quad = 0; quad < quads_per_cmd; ++quad)
+          AddQuad(*cmd_list, quad);
+      }
+      cmd_lists_.push_back(cmd_list.get());
+      lists_.push_back(std::move(cmd_list));
+    }
+    draw_data_.Valid = true;
+    draw_data_.CmdLists = cmd_lists_.data();
+    draw_data_.CmdListsCount = lists_count;
+  }
+
+  ImDrawData& DrawData() {
+    return draw_data_;
+  }
+
+  void TouchList(int list) {
+    lists_[list]->VtxBuffer[0].col ^= 1;
+  }
+
+ private:
+  static void AddQuad(ImDrawList& cmd_list, int quad) {
+    ImDrawIdx base = static_cast<ImDrawIdx>(cmd_list.VtxBuffer.size());
+    float x = static_cast<float>(quad % 64) * 16.0f;
+    float y = static_cast<float>(quad / 64) * 16.0f;
+    for (int corner = 0; corner < 4; ++corner) {
+      ImDrawVert vtx;
+      vtx.pos = ImVec2(x + (corner & 1) * 16.0f, y + (corner >> 1) * 16.0f);
+      vtx.uv = ImVec2((corner & 1) * 1.0f, (corner >> 1) * 1.0f);
+      vtx.col = 0xFFFFFFFF;
+      cmd_list.VtxBuffer.push_back(vtx);
+    }
+    for (ImDrawIdx idx : {0, 1, 2, 1, 3, 2})
+      cmd_list.IdxBuffer.push_back(base + idx);
+  }
+
+  std::vector<std::unique_ptr<ImDrawList>> lists_;
+  std::vector<ImDrawList*> cmd_lists_;
+  ImDrawData draw_data_;
+};
+
+struct BenchmarkCase {
+  char const* name;
+  int lists_count;
+  int cmds_per_list;
+  int quads_per_cmd;
+  int textures_count;
+};
+
+constexpr BenchmarkCase kBenchmarkCases[] = {
+  {"BM_ManySmallLists/256", 256, 2, 8, 1},
+  {"BM_FewHugeLists/4", 4, 8, 2000, 1},
+  {"BM_ManyTextures/64", 8, 64, 16, 64},
+  {"BM_TypicalFrame/12", 12, 6, 64, 2},
+};
+
+constexpr std::chrono::milliseconds kMinBenchmarkTime{500};
+
+bool ExpectRecorded(char const* name, char const* counter, uint64_t recorded,
+                    uint64_t expected) {
+  if (recorded == expected)
+    return true;
+  std::fprintf(stderr, "%s: recorded %llu %s, expected %llu\n", name,
+      static_cast<unsigned long long>(recorded), counter,
+      static_cast<unsigned long long>(expected));
+  return false;
+}
+
+bool VerifySubmission(RecordingGlesDevice& device, BenchmarkCase const& bench,
+                      SyntheticDrawData& synthetic) {
+  emgui::RecordingGlesApi::Reset();
+  device.DrawLists(synthetic.DrawData());
+  auto const& record = emgui::RecordingGlesApi::record;
+  uint64_t cmds = static_cast<uint64_t>(bench.lists_count) * bench.cmds_per_list;
+  uint64_t quads = cmds * bench.quads_per_cmd;
+  bool verified = true;
+  verified &= ExpectRecorded(bench.name, "draw calls", record.draw_calls, cmds);
+  verified &= ExpectRecorded(bench.name, "elements", record.elements, quads * 6);
+  verified &= ExpectRecorded(bench.name, "texture binds", record.texture_binds,
+      cmds);
+  verified &= ExpectRecorded(bench.name, "buffer uploads",
+      record.buffer_uploads, 2 * static_cast<uint64_t>(bench.lists_count));
+  verified &= ExpectRecorded(bench.name, "uploaded bytes",
+      record.buffer_upload_bytes,
+      quads * (4 * sizeof(ImDrawVert) + 6 * sizeof(ImDrawIdx)));
+  return verified;
+}
+
+bool RunBenchmark(RecordingGlesDevice& device, BenchmarkCase const& bench) {
+  SyntheticDrawData synthetic(bench.lists_count, bench.cmds_per_list,
+      bench.quads_per_cmd, bench.textures_count);
+  if (!VerifySubmission(device, bench, synthetic))
+    return false;
+  emgui::RecordingGlesApi::Reset();
+
+  uint64_t iterations = 0;
+  auto start = std::chrono::steady_clock::now();
+  auto elapsed = std::chrono::steady_clock::duration::zero();
+  while (elapsed < kMinBenchmarkTime) {
+    for (int i = 0; i < 64; ++i)
+      device.DrawLists(synthetic.DrawData());
+    iterations += 64;
+    elapsed = std::chrono::steady_clock::now() - start;
+  }
+
+  auto const& record = emgui::RecordingGlesApi::record;
+  double ns_per_frame =
+      std::chrono::duration<double, std::nano>(elapsed).count() / iterations;
+  std::printf("%-24s %12.0f ns %10llu %12llu %10llu %14llu\n", bench.name,
+      ns_per_frame, static_cast<unsigned long long>(iterations),
+      static_cast<unsigned long long>(record.calls / iterations),
+      static_cast<unsigned long long>(record.draw_calls / iterations),
+      static_cast<unsigned long long>(record.buffer_upload_bytes / iterations));
+  return true;
+}
+
+struct CodecBenchmarkCase {
+  char const* name;
+  BenchmarkCase shape;
+  int lists_changed_per_frame;
+};
+
+constexpr CodecBenchmarkCase kCodecBenchmarkCases[] = {
+  {"BM_CodecStatic/12", kBenchmarkCases[3], 0},
+  {"BM_CodecOneChanged/12", kBenchmarkCases[3], 1},
+  {"BM_CodecAllChanged/12", kBenchmarkCases[3], 12},
+  {"BM_CodecManySmallLists/256", kBenchmarkCases[0], 4},
+};
+
+double MegabytesPerSecond(uint64_t bytes, std::chrono::nanoseconds elapsed) {
+  return elapsed.count() == 0 ? 0.0 : bytes * 1e3 / elapsed.count();
+}
+
+void RunCodecBenchmark(CodecBenchmarkCase const& bench) {
+  BenchmarkCase const& shape = bench.shape;
+  SyntheticDrawData synthetic(shape.lists_count, shape.cmds_per_list,
+      shape.quads_per_cmd, shape.textures_count);
+  emgui::BufferByteSink sink;
+  emgui::DrawDataEncoder encoder(sink);
+  emgui::DrawDataDecoder decoder;
+  encoder.Encode(synthetic.DrawData());
+  sink.Consume(decoder.Decode(sink.Data(), sink.Size()));
+
+  uint64_t iterations = 0;
+  uint64_t raw_bytes = 0;
+  uint64_t coded_raw_bytes = 0;
+  uint64_t encoded_bytes = 0;
+  std::chrono::nanoseconds encode_time{0};
+  std::chrono::nanoseconds decode_time{0};
+  while (encode_time + decode_time < kMinBenchmarkTime) {
+    for (int i = 0; i < bench.lists_changed_per_frame; ++i)
+      synthetic.TouchList((iterations + i) % shape.lists_count);
+    encoder.Encode(synthetic.DrawData());
+    sink.Consume(decoder.Decode(sink.Data(), sink.Size()));
+    raw_bytes += encoder.LastFrameStats().raw_bytes;
+    coded_raw_bytes += encoder.LastFrameStats().coded_raw_bytes;
+    encoded_bytes += encoder.LastFrameStats().encoded_bytes;
+    encode_time += encoder.LastFrameStats().elapsed;
+    decode_time += decoder.LastFrameStats().elapsed;
+    ++iterations;
+  }
+
+  std::printf("%-28s %10llu %10llu %10llu %10llu "
+      "%9lld ns %9lld ns %10.1f %10.1f\n", bench.name, static_cast<unsigned long long>(raw_bytes / iterations),
+      static_cast<unsigned long long>(coded_raw_bytes / iterations),
+      static_cast<unsigned long long>(encoded_bytes / iterations),
+      static_cast<unsigned long long>(iterations),
+      static_cast<long long>(encode_time.count() / iterations),
+      static_cast<long long>(decode_time.count() / iterations),
+      MegabytesPerSecond(coded_raw_bytes, encode_time),
+      MegabytesPerSecond(coded_raw_bytes, decode_time));
+}
+
+} // namespace <anonymous>
+
+int main()
+{
+  ImGui::GetIO().DisplaySize = ImVec2(1920.0f, 1080.0f);
+  bool verified = true;
+  {
+    RecordingGlesDevice device;
+    std::printf("%-24s %15s %10s %12s %10s %14s\n", "Benchmark", "Time",
+        "Iterations", "GlCalls", "Draws", "UploadBytes");
+    for (BenchmarkCase const& bench : kBenchmarkCases)
+      verified &= RunBenchmark(device, bench);
+  }
+  std::printf("\n%-28s %10s %10s %10s %10s %12s %12s %10s %10s\n",
+      "Benchmark", "RawBytes", "CodedBytes", "Encoded", "Iterations",
+      "Encode", "Decode", "EncodeMB/s", "DecodeMB/s");
+  for (CodecBenchmarkCase const& bench : kCodecBenchmarkCases)
+    RunCodecBenchmark(bench);
+  ImGui::Shutdown();
+  return verified ? 0 : 1;
+}
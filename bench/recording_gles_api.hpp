@@ -0,0 +1,208 @@
+#ifndef EMGUI_BENCH_RECORDING_GLES_API_HPP_
+#define EMGUI_BENCH_RECORDING_GLES_API_HPP_
+
+#include <cstdint>
+
+#include <SDL_opengl.h>
+
+namespace emgui {
+
+struct GlesApiRecord {
+  uint64_t calls = 0;
+  uint64_t draw_calls = 0;
+  uint64_t elements = 0;
+  uint64_t texture_binds = 0;
+  uint64_t buffer_uploads = 0;
+  uint64_t buffer_upload_bytes = 0;
+  GLuint last_name = 0;
+};
+
+// GL dispatch which never touches a context and only counts what would have
+// been submitted, so that the CPU side of GlesDevice can be measured alone.
+struct RecordingGlesApi {
+  static inline GlesApiRecord record;
+
+  static void Reset() {
+    GLuint last_name = record.last_name;
+    record = GlesApiRecord{};
+    record.last_name = last_name;
+  }
+
+  static void GenBuffers(GLsizei n, GLuint* buffers) {
+    GenNames(n, buffers);
+  }
+
+  static void DeleteBuffers(GLsizei, GLuint const*) {
+    ++record.calls;
+  }
+
+  static void BindBuffer(GLenum, GLuint) {
+    ++record.calls;
+  }
+
+  static void BufferData(GLenum, GLsizeiptr size, GLvoid const*, GLenum) {
+    ++record.calls;
+    ++record.buffer_uploads;
+    record.buffer_upload_bytes += size;
+  }
+
+  static void GenTextures(GLsizei n, GLuint* textures) {
+    GenNames(n, textures);
+  }
+
+  static void DeleteTextures(GLsizei, GLuint const*) {
+    ++record.calls;
+  }
+
+  static void BindTexture(GLenum, GLuint) {
+    ++record.calls;
+    ++record.texture_binds;
+  }
+
+  static void ActiveTexture(GLenum) {
+    ++record.calls;
+  }
+
+  static void TexParameteri(GLenum, GLenum, GLint) {
+    ++record.calls;
+  }
+
+  static void TexImage2D(GLenum, GLint, GLint, GLsizei, GLsizei, GLint, GLenum,
+                         GLenum, GLvoid const*) {
+    ++record.calls;
+  }
+
+  static GLuint CreateShader(GLenum) {
+    ++record.calls;
+    return ++record.last_name;
+  }
+
+  static void DeleteShader(GLuint) {
+    ++record.calls;
+  }
+
+  static void ShaderSource(GLuint, GLsizei, GLchar const* const*, GLint const*) {
+    ++record.calls;
+  }
+
+  static void CompileShader(GLuint) {
+    ++record.calls;
+  }
+
+  static void GetShaderiv(GLuint, GLenum, GLint* params) {
+    ++record.calls;
+    *params = GL_TRUE;
+  }
+
+  static void GetShaderInfoLog(GLuint, GLsizei max_length, GLsizei* length,
+                               GLchar* info_log) {
+    ++record.calls;
+    if (length)
+      *length = 0;
+    if (max_length > 0)
+      info_log[0] = '\0';
+  }
+
+  static void AttachShader(GLuint, GLuint) {
+    ++record.calls;
+  }
+
+  static void DetachShader(GLuint, GLuint) {
+    ++record.calls;
+  }
+
+  static GLuint CreateProgram() {
+    ++record.calls;
+    return ++record.last_name;
+  }
+
+  static void DeleteProgram(GLuint) {
+    ++record.calls;
+  }
+
+  static void LinkProgram(GLuint) {
+    ++record.calls;
+  }
+
+  static void UseProgram(GLuint) {
+    ++record.calls;
+  }
+
+  static void GetProgramiv(GLuint, GLenum, GLint* params) {
+    ++record.calls;
+    *params = GL_TRUE;
+  }
+
+  static void GetProgramInfoLog(GLuint, GLsizei max_length, GLsizei* length,
+                                GLchar* info_log) {
+    GetShaderInfoLog(0, max_length, length, info_log);
+  }
+
+  static GLint GetUniformLocation(GLuint, GLchar const*) {
+    ++record.calls;
+    return 0;
+  }
+
+  static GLint GetAttribLocation(GLuint, GLchar const*) {
+    ++record.calls;
+    return 0;
+  }
+
+  static void Uniform1i(GLint, GLint) {
+    ++record.calls;
+  }
+
+  static void UniformMatrix4fv(GLint, GLsizei, GLboolean, GLfloat const*) {
+    ++record.calls;
+  }
+
+  static void VertexAttribPointer(GLuint, GLint, GLenum, GLboolean, GLsizei,
+                                  GLvoid const*) {
+    ++record.calls;
+  }
+
+  static void EnableVertexAttribArray(GLuint) {
+    ++record.calls;
+  }
+
+  static void DisableVertexAttribArray(GLuint) {
+    ++record.calls;
+  }
+
+  static void Enable(GLenum) {
+    ++record.calls;
+  }
+
+  static void Disable(GLenum) {
+    ++record.calls;
+  }
+
+  static void BlendEquation(GLenum) {
+    ++record.calls;
+  }
+
+  static void BlendFunc(GLenum, GLenum) {
+    ++record.calls;
+  }
+
+  static void Scissor(GLint, GLint, GLsizei, GLsizei) {
+    ++record.calls;
+  }
+
+  static void DrawElements(GLenum, GLsizei count, GLenum, GLvoid const*) {
+    ++record.calls;
+    ++record.draw_calls;
+    record.elements += count;
+  }
+
+ private:
+  static void GenNames(GLsizei n, GLuint* names) {
+    ++record.calls;
+    for (GLsizei i = 0; i < n; ++i)
+      names[i] = ++record.last_name;
+  }
+};
+
+} // namespace emgui
+
+#endif // EMGUI_BENCH_RECORDING_GLES_API_HPP_
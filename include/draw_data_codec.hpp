@@ -0,0 +1,197 @@
+#ifndef EMGUI_INCLUDE_DRAW_DATA_CODEC_HPP_
+#define EMGUI_INCLUDE_DRAW_DATA_CODEC_HPP_
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "imgui.h"
+
+namespace emgui {
+namespace detail {
+
+class FrameReader;
+
+} // namespace detail
+
+class ByteSink {
+ public:
+  virtual void Write(uint8_t const* data, size_t size) = 0;
+  virtual ~ByteSink() = default;
+};
+
+class BufferByteSink final : public ByteSink {
+ public:
+  void Write(uint8_t const* data, size_t size) final {
+    buffer_.insert(buffer_.end(), data, data + size);
+  }
+
+  uint8_t const* Data() const {
+    return buffer_.data();
+  }
+
+  size_t Size() const {
+    return buffer_.size();
+  }
+
+  void Consume(size_t size) {
+    buffer_.erase(buffer_.begin(), buffer_.begin() + size);
+  }
+
+ private:
+  std::vector<uint8_t> buffer_;
+};
+
+// Thrown by DrawDataDecoder::Decode on a malformed frame. FrameSize() is the
+// number of bytes to consume to skip it, or 1 when the frame header itself is
+// unusable and the stream has to be rescanned for the next frame.
+class DrawDataFrameError : public std::invalid_argument {
+ public:
+  DrawDataFrameError(std::string const& what, size_t frame_size)
+      : std::invalid_argument(what), frame_size_(frame_size) {}
+
+  size_t FrameSize() const {
+    return frame_size_;
+  }
+
+ private:
+  size_t frame_size_;
+};
+
+struct DrawDataCodecStats {
+  size_t raw_bytes = 0;
+  size_t coded_raw_bytes = 0;
+  size_t encoded_bytes = 0;
+  int lists_count = 0;
+  int lists_reused = 0;
+  std::chrono::nanoseconds elapsed{0};
+};
+
+// Frames are written as [magic][varint payload size][payload]. The payload
+// starts with a frame sequence number, a keyframe flag and the encoder's
+// ImGuiIO display size and framebuffer scale. Lists that did not change since
+// the previous frame are sent as a bare id, all others carry quantized
+// vertices and delta coded indices. Draw callbacks are not serializable and
+// are dropped. Keyframes carry every list in full, the decoder rejects any
+// other frame that does not directly follow the last one it decoded, so a
+// client which joined late or dropped a frame has to ask for Reset().
+//
+// Texture ids and font atlas pixels are not transmitted. The client has to
+// build the same font atlas as the encoding process, so that uvs match, and
+// map the encoder's texture ids to its own with DrawDataDecoder::MapTexture,
+// at least the encoder's Fonts->TexID to the client's one.
+class DrawDataEncoder {
+ public:
+  explicit DrawDataEncoder(ByteSink& sink) : sink_(sink) {}
+
+  DrawDataEncoder(DrawDataEncoder const&) = delete;
+  DrawDataEncoder& operator=(DrawDataEncoder const&) = delete;
+
+  void Encode(ImDrawData const& draw_data);
+
+  // Forgets every list sent so far, the next frame is encoded as a keyframe.
+  void Reset() {
+    lists_.clear();
+  }
+
+  DrawDataCodecStats const& LastFrameStats() const {
+    return stats_;
+  }
+
+ private:
+  struct CachedList {
+    uint32_t id = 0;
+    uint32_t frame = 0;
+    std::vector<ImDrawVert> vtx_buffer;
+    std::vector<ImDrawIdx> idx_buffer;
+    std::vector<ImDrawCmd> cmd_buffer;
+  };
+
+  bool UpdateCachedList(CachedList& cached, ImDrawList const& cmd_list) const;
+  void EncodeList(CachedList const& cached);
+
+  ByteSink& sink_;
+  std::unordered_map<ImDrawList const*, CachedList> lists_;
+  std::vector<uint8_t> payload_;
+  uint32_t next_list_id_ = 0;
+  uint32_t frame_ = 0;
+  DrawDataCodecStats stats_;
+};
+
+class DrawDataDecoder {
+ public:
+  DrawDataDecoder() = default;
+
+  DrawDataDecoder(DrawDataDecoder const&) = delete;
+  DrawDataDecoder& operator=(DrawDataDecoder const&) = delete;
+
+  // Returns the number of bytes consumed, or 0 if the buffer does not hold a
+  // complete frame yet. Throws DrawDataFrameError on a malformed or out of
+  // sequence frame, which leaves the previously decoded frame and list cache
+  // untouched.
+  size_t Decode(uint8_t const* data, size_t size);
+
+  // Valid until the next call to Decode. GlesDevice::DrawLists may rescale
+  // clip rects in place, every frame restores them from the decoded copy.
+  ImDrawData& DrawData() {
+    return draw_data_;
+  }
+
+  // Display size and framebuffer scale of the last decoded frame, to be
+  // copied into the client's ImGuiIO before GlesDevice::DrawLists.
+  ImVec2 const& DisplaySize() const {
+    return display_size_;
+  }
+
+  ImVec2 const& DisplayFramebufferScale() const {
+    return display_framebuffer_scale_;
+  }
+
+  void MapTexture(ImTextureID encoded, ImTextureID local) {
+    texture_map_[encoded] = local;
+  }
+
+  DrawDataCodecStats const& LastFrameStats() const {
+    return stats_;
+  }
+
+ private:
+  struct DecodedList {
+    uint32_t frame = 0;
+    ImDrawList cmd_list;
+    std::vector<ImDrawCmd> cmd_buffer;
+  };
+
+  // A frame is decoded into pending lists first and only replaces the
+  // decoder state once it has been fully validated.
+  struct PendingList {
+    uint32_t id = 0;
+    std::unique_ptr<DecodedList> decoded;
+  };
+
+  void DecodeList(detail::FrameReader& reader, DecodedList& decoded) const;
+  bool HasList(uint32_t id) const;
+  std::unique_ptr<DecodedList> AcquireList();
+
+  std::unordered_map<uint32_t, std::unique_ptr<DecodedList>> lists_;
+  std::vector<std::unique_ptr<DecodedList>> spare_lists_;
+  std::vector<PendingList> pending_lists_;
+  std::unordered_map<ImTextureID, ImTextureID> texture_map_;
+  std::vector<ImDrawList*> cmd_lists_;
+  ImVec2 display_size_;
+  ImVec2 display_framebuffer_scale_{1.0f, 1.0f};
+  ImDrawData draw_data_;
+  uint32_t frame_ = 0;
+  bool has_sequence_ = false;
+  uint32_t sequence_ = 0;
+  DrawDataCodecStats stats_;
+};
+
+} // namespace emgui
+
+#endif // EMGUI_INCLUDE_DRAW_DATA_CODEC_HPP_
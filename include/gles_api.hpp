@@ -0,0 +1,171 @@
+#ifndef EMGUI_INCLUDE_GLES_API_HPP_
+#define EMGUI_INCLUDE_GLES_API_HPP_
+
+#include <SDL_opengl.h>
+
+namespace emgui {
+
+struct GlesApi {
+  static void GenBuffers(GLsizei n, GLuint* buffers) {
+    glGenBuffers(n, buffers);
+  }
+
+  static void DeleteBuffers(GLsizei n, GLuint const* buffers) {
+    glDeleteBuffers(n, buffers);
+  }
+
+  static void BindBuffer(GLenum target, GLuint buffer) {
+    glBindBuffer(target, buffer);
+  }
+
+  static void BufferData(GLenum target, GLsizeiptr size, GLvoid const* data,
+                         GLenum usage) {
+    glBufferData(target, size, data, usage);
+  }
+
+  static void GenTextures(GLsizei n, GLuint* textures) {
+    glGenTextures(n, textures);
+  }
+
+  static void DeleteTextures(GLsizei n, GLuint const* textures) {
+    glDeleteTextures(n, textures);
+  }
+
+  static void BindTexture(GLenum target, GLuint texture) {
+    glBindTexture(target, texture);
+  }
+
+  static void ActiveTexture(GLenum texture) {
+    glActiveTexture(texture);
+  }
+
+  static void TexParameteri(GLenum target, GLenum pname, GLint param) {
+    glTexParameteri(target, pname, param);
+  }
+
+  static void TexImage2D(GLenum target, GLint level, GLint internal_format,
+                         GLsizei width, GLsizei height, GLint border,
+                         GLenum format, GLenum type, GLvoid const* pixels) {
+    glTexImage2D(target, level, internal_format, width, height, border, format,
+        type, pixels);
+  }
+
+  static GLuint CreateShader(GLenum type) {
+    return glCreateShader(type);
+  }
+
+  static void DeleteShader(GLuint shader) {
+    glDeleteShader(shader);
+  }
+
+  static void ShaderSource(GLuint shader, GLsizei count,
+                           GLchar const* const* source, GLint const* length) {
+    glShaderSource(shader, count, source, length);
+  }
+
+  static void CompileShader(GLuint shader) {
+    glCompileShader(shader);
+  }
+
+  static void GetShaderiv(GLuint shader, GLenum pname, GLint* params) {
+    glGetShaderiv(shader, pname, params);
+  }
+
+  static void GetShaderInfoLog(GLuint shader, GLsizei max_length,
+                               GLsizei* length, GLchar* info_log) {
+    glGetShaderInfoLog(shader, max_length, length, info_log);
+  }
+
+  static void AttachShader(GLuint program, GLuint shader) {
+    glAttachShader(program, shader);
+  }
+
+  static void DetachShader(GLuint program, GLuint shader) {
+    glDetachShader(program, shader);
+  }
+
+  static GLuint CreateProgram() {
+    return glCreateProgram();
+  }
+
+  static void DeleteProgram(GLuint program) {
+    glDeleteProgram(program);
+  }
+
+  static void LinkProgram(GLuint program) {
+    glLinkProgram(program);
+  }
+
+  static void UseProgram(GLuint program) {
+    glUseProgram(program);
+  }
+
+  static void GetProgramiv(GLuint program, GLenum pname, GLint* params) {
+    glGetProgramiv(program, pname, params);
+  }
+
+  static void GetProgramInfoLog(GLuint program, GLsizei max_length,
+                                GLsizei* length, GLchar* info_log) {
+    glGetProgramInfoLog(program, max_length, length, info_log);
+  }
+
+  static GLint GetUniformLocation(GLuint program, GLchar const* name) {
+    return glGetUniformLocation(program, name);
+  }
+
+  static GLint GetAttribLocation(GLuint program, GLchar const* name) {
+    return glGetAttribLocation(program, name);
+  }
+
+  static void Uniform1i(GLint location, GLint value) {
+    glUniform1i(location, value);
+  }
+
+  static void UniformMatrix4fv(GLint location, GLsizei count,
+                               GLboolean transpose, GLfloat const* value) {
+    glUniformMatrix4fv(location, count, transpose, value);
+  }
+
+  static void VertexAttribPointer(GLuint index, GLint size, GLenum type,
+                                  GLboolean normalized, GLsizei stride,
+                                  GLvoid const* pointer) {
+    glVertexAttribPointer(index, size, type, normalized, stride, pointer);
+  }
+
+  static void EnableVertexAttribArray(GLuint index) {
+    glEnableVertexAttribArray(index);
+  }
+
+  static void DisableVertexAttribArray(GLuint index) {
+    glDisableVertexAttribArray(index);
+  }
+
+  static void Enable(GLenum cap) {
+    glEnable(cap);
+  }
+
+  static void Disable(GLenum cap) {
+    glDisable(cap);
+  }
+
+  static void BlendEquation(GLenum mode) {
+    glBlendEquation(mode);
+  }
+
+  static void BlendFunc(GLenum sfactor, GLenum dfactor) {
+    glBlendFunc(sfactor, dfactor);
+  }
+
+  static void Scissor(GLint x, GLint y, GLsizei width, GLsizei height) {
+    glScissor(x, y, width, height);
+  }
+
+  static void DrawElements(GLenum mode, GLsizei count, GLenum type,
+                           GLvoid const* indices) {
+    glDrawElements(mode, count, type, indices);
+  }
+};
+
+} // namespace emgui
+
+#endif // EMGUI_INCLUDE_GLES_API_HPP_
@@ -1,22 +1,27 @@
 #ifndef EMGUI_INCLUDE_GLES_DEVICE_HPP_
 #define EMGUI_INCLUDE_GLES_DEVICE_HPP_
 
+#include <cstdint>
 #include <optional>
 #include <sstream>
+#include <tuple>
 #include <type_traits>
+#include <utility>
 
 #include <SDL_opengl.h>
 
+#include "gles_api.hpp"
 #include "imgui.h"
 
 namespace emgui {
 namespace detail {
 
+template <typename Gl>
 class GlesDeviceBuffer {
  public:
   explicit GlesDeviceBuffer(GLenum target) : target_(target) {
     GLuint buffer_name = 0;
-    glGenBuffers(1, &buffer_name);
+    Gl::GenBuffers(1, &buffer_name);
     buffer_ = buffer_name;
   }
 
@@ -30,16 +35,16 @@ class GlesDeviceBuffer {
 
   ~GlesDeviceBuffer() {
     if (buffer_.has_value())
-      glDeleteBuffers(1, &buffer_.value());
+      Gl::DeleteBuffers(1, &buffer_.value());
   }
 
   void LoadData(GLvoid const* data, GLsizeiptr size) {
-    glBindBuffer(target_.value(), buffer_.value());
-    glBufferData(target_.value(), size, data, GL_STREAM_DRAW);
+    Gl::BindBuffer(target_.value(), buffer_.value());
+    Gl::BufferData(target_.value(), size, data, GL_STREAM_DRAW);
   }
 
   void Bind() {
-    glBindBuffer(target_.value(), buffer_.value());
+    Gl::BindBuffer(target_.value(), buffer_.value());
   }
 
  private:
@@ -47,15 +52,16 @@ class GlesDeviceBuffer {
   std::optional<GLuint> buffer_;
 };
 
+template <typename Gl>
 class GlesDeviceFont {
  public:
   GlesDeviceFont() {
     GLuint texture_name = 0;
-    glGenTextures(1, &texture_name);
-    glBindTexture(GL_TEXTURE_2D, texture_name);
+    Gl::GenTextures(1, &texture_name);
+    Gl::BindTexture(GL_TEXTURE_2D, texture_name);
     font_texture_ = texture_name;
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    Gl::TexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    Gl::TexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
     LoadDefaultFontTexImage();
     ImGui::GetIO().Fonts->TexID = reinterpret_cast<void *>(font_texture_.value());
   }
@@ -69,7 +75,7 @@ class GlesDeviceFont {
 
   ~GlesDeviceFont() {
     if (font_texture_.has_value())
-      glDeleteTextures(1, &font_texture_.value());
+      Gl::DeleteTextures(1, &font_texture_.value());
   }
 
  private:
@@ -78,11 +84,12 @@ class GlesDeviceFont {
   std::optional<GLuint> font_texture_;
 };
 
+template <typename Gl>
 class GlesDeviceShader {
  public:
   GlesDeviceShader(GLuint program, GLenum type, const char* source)
       : shader_(CreateShader(type, source)), program_attached_(program) {
-    glAttachShader(program_attached_.value(), shader_.value());
+    Gl::AttachShader(program_attached_.value(), shader_.value());
   }
 
   GlesDeviceShader(GlesDeviceShader const&) = delete;
@@ -95,8 +102,8 @@ class GlesDeviceShader {
 
   virtual ~GlesDeviceShader() {
     if (program_attached_.has_value() && shader_.has_value()) {
-      glDetachShader(program_attached_.value(), shader_.value());
-      glDeleteShader(shader_.value());
+      Gl::DetachShader(program_attached_.value(), shader_.value());
+      Gl::DeleteShader(shader_.value());
     }
   }
 
@@ -107,12 +114,12 @@ class GlesDeviceShader {
  protected:
   template <typename... Args>
   GLint GetUniformLocation(Args&&... args) const {
-    return glGetUniformLocation(program_attached_.value(), std::forward<Args>(args)...);
+    return Gl::GetUniformLocation(program_attached_.value(), std::forward<Args>(args)...);
   }
 
   template <typename... Args>
   GLint GetAttribLocation(Args&&... args) const {
-    return glGetAttribLocation(program_attached_.value(), std::forward<Args>(args)...);
+    return Gl::GetAttribLocation(program_attached_.value(), std::forward<Args>(args)...);
   }
 
  private:
@@ -122,13 +129,14 @@ class GlesDeviceShader {
   std::optional<GLuint> program_attached_;
 };
 
-class GlesDeviceVertexShader final : public GlesDeviceShader {
+template <typename Gl>
+class GlesDeviceVertexShader final : public GlesDeviceShader<Gl> {
  public:
   explicit GlesDeviceVertexShader(GLuint program)
-      : GlesDeviceShader(program, GL_VERTEX_SHADER, kShaderSource) {}
+      : GlesDeviceShader<Gl>(program, GL_VERTEX_SHADER, kShaderSource) {}
 
   GlesDeviceVertexShader(GlesDeviceVertexShader&& other) noexcept
-      : GlesDeviceShader(std::move(other)) {
+      : GlesDeviceShader<Gl>(std::move(other)) {
     std::swap(proj_mat_loc_, other.proj_mat_loc_);
     std::swap(position_loc_, other.position_loc_);
     std::swap(texture_coord_loc_, other.texture_coord_loc_);
@@ -136,18 +144,18 @@ class GlesDeviceVertexShader final : public GlesDeviceShader {
   }
 
   void LoadAttributesLocation() final {
-    proj_mat_loc_ = GetUniformLocation("proj_mat");
-    position_loc_ = GetAttribLocation("position");
-    texture_coord_loc_ = GetAttribLocation("frag_texture_coord");
-    texture_color_loc_ = GetAttribLocation("frag_texture_color");
+    proj_mat_loc_ = this->GetUniformLocation("proj_mat");
+    position_loc_ = this->GetAttribLocation("position");
+    texture_coord_loc_ = this->GetAttribLocation("frag_texture_coord");
+    texture_color_loc_ = this->GetAttribLocation("frag_texture_color");
   }
 
   void Enable() final;
 
   void Disable() final {
-    glDisableVertexAttribArray(position_loc_.value());
-    glDisableVertexAttribArray(texture_coord_loc_.value());
-    glDisableVertexAttribArray(texture_color_loc_.value());
+    Gl::DisableVertexAttribArray(position_loc_.value());
+    Gl::DisableVertexAttribArray(texture_coord_loc_.value());
+    Gl::DisableVertexAttribArray(texture_color_loc_.value());
   }
 
  private:
@@ -173,22 +181,23 @@ class GlesDeviceVertexShader final : public GlesDeviceShader {
   std::optional<GLint> texture_color_loc_;
 };
 
-class GlesDeviceFragmentShader final : public GlesDeviceShader {
+template <typename Gl>
+class GlesDeviceFragmentShader final : public GlesDeviceShader<Gl> {
  public:
   explicit GlesDeviceFragmentShader(GLuint program)
-      : GlesDeviceShader(program, GL_FRAGMENT_SHADER, kShaderSource) {}
+      : GlesDeviceShader<Gl>(program, GL_FRAGMENT_SHADER, kShaderSource) {}
 
   GlesDeviceFragmentShader(GlesDeviceFragmentShader&& other) noexcept
-      : GlesDeviceShader(std::move(other)) {
+      : GlesDeviceShader<Gl>(std::move(other)) {
     std::swap(texture_loc_, other.texture_loc_);
   }
 
   void LoadAttributesLocation() final {
-    texture_loc_ = GetUniformLocation("texture");
+    texture_loc_ = this->GetUniformLocation("texture");
   }
 
   void Enable() final {
-    glUniform1i(texture_loc_.value(), 0);
+    Gl::Uniform1i(texture_loc_.value(), 0);
   }
 
  private:
@@ -205,11 +214,11 @@ class GlesDeviceFragmentShader final : public GlesDeviceShader {
   std::optional<GLint> texture_loc_;
 };
 
-template <typename... Shaders>
+template <typename Gl, typename... Shaders>
 class GlesDeviceProgram {
  public:
   GlesDeviceProgram()
-      : program_(glCreateProgram()), shaders_(Shaders(program_.value())...) {
+      : program_(Gl::CreateProgram()), shaders_(Shaders(program_.value())...) {
     LinkProgram(program_.value());
     ForeachShader([](auto& shader) { shader.LoadAttributesLocation(); });
   }
@@ -223,7 +232,7 @@ class GlesDeviceProgram {
 
   ~GlesDeviceProgram() {
     if (program_.has_value())
-      glDeleteProgram(program_.value());
+      Gl::DeleteProgram(program_.value());
   }
 
   void DrawLists(ImDrawData const& draw_data) {
@@ -241,7 +250,7 @@ class GlesDeviceProgram {
  private:
   struct ScopedProgramLoader {
     ScopedProgramLoader(GlesDeviceProgram& program) : hosted_program_(program) {
-      glUseProgram(hosted_program_.program_.value());
+      Gl::UseProgram(hosted_program_.program_.value());
       hosted_program_.array_buffer_.Bind();
       hosted_program_.ForeachShader([](auto& shader) { shader.Enable(); });
     }
@@ -268,23 +277,24 @@ class GlesDeviceProgram {
         "glDrawElements expects indices of type GL_UNSIGNED_SHORT");
     std::uintptr_t idx_buffer_offset = 0;
     for (auto cmd = cmd_buffer.begin(); cmd != cmd_buffer.end(); ++cmd) {
-      glBindTexture(GL_TEXTURE_2D, reinterpret_cast<GLuint>(cmd->TextureId));
+      Gl::BindTexture(GL_TEXTURE_2D,
+          static_cast<GLuint>(reinterpret_cast<std::uintptr_t>(cmd->TextureId)));
       GLsizei width = cmd->ClipRect.z - cmd->ClipRect.x;
       GLsizei height = cmd->ClipRect.w - cmd->ClipRect.y;
-      glScissor(cmd->ClipRect.x, cmd->ClipRect.y, width, height);
-      glDrawElements(GL_TRIANGLES, cmd->ElemCount, GL_UNSIGNED_SHORT,
+      Gl::Scissor(cmd->ClipRect.x, cmd->ClipRect.y, width, height);
+      Gl::DrawElements(GL_TRIANGLES, cmd->ElemCount, GL_UNSIGNED_SHORT,
           reinterpret_cast<GLvoid const*>(idx_buffer_offset));
       idx_buffer_offset += cmd->ElemCount * sizeof(ImDrawIdx);
     }
   }
 
   void LinkProgram(GLuint program) {
-    glLinkProgram(program);
+    Gl::LinkProgram(program);
     GLint link_status = GL_FALSE;
-    glGetProgramiv(program, GL_LINK_STATUS, &link_status);
+    Gl::GetProgramiv(program, GL_LINK_STATUS, &link_status);
     if (link_status == GL_FALSE) {
       char info_log[256];
-      glGetProgramInfoLog(program, sizeof(info_log), NULL, info_log);
+      Gl::GetProgramInfoLog(program, sizeof(info_log), NULL, info_log);
       std::stringstream os;
       os << "glLinkProgram failed with error : " << info_log;
       throw std::invalid_argument(os.str());
@@ -293,27 +303,45 @@ class GlesDeviceProgram {
 
   std::optional<GLuint> program_;
   std::tuple<Shaders...> shaders_;
-  GlesDeviceBuffer array_buffer_{GL_ARRAY_BUFFER};
-  GlesDeviceBuffer element_array_buffer_{GL_ELEMENT_ARRAY_BUFFER};
+  GlesDeviceBuffer<Gl> array_buffer_{GL_ARRAY_BUFFER};
+  GlesDeviceBuffer<Gl> element_array_buffer_{GL_ELEMENT_ARRAY_BUFFER};
 };
 
 } // namespace detail
 
-class GlesDevice {
+template <typename Gl>
+class BasicGlesDevice {
  public:
-  GlesDevice() = default;
+  BasicGlesDevice() = default;
 
-  GlesDevice(GlesDevice const&) = delete;
-  GlesDevice& operator=(GlesDevice const&) = delete;
+  BasicGlesDevice(BasicGlesDevice const&) = delete;
+  BasicGlesDevice& operator=(BasicGlesDevice const&) = delete;
 
   void DrawLists(ImDrawData& draw_data);
 
  private:
-  detail::GlesDeviceProgram<
-      detail::GlesDeviceVertexShader, detail::GlesDeviceFragmentShader> program_;
-  detail::GlesDeviceFont font_;
+  detail::GlesDeviceProgram<Gl, detail::GlesDeviceVertexShader<Gl>,
+      detail::GlesDeviceFragmentShader<Gl>> program_;
+  detail::GlesDeviceFont<Gl> font_;
 };
 
+using GlesDevice = BasicGlesDevice<GlesApi>;
+
+} // namespace emgui
+
+#include "gles_device_impl.hpp"
+
+namespace emgui {
+namespace detail {
+
+extern template class GlesDeviceFont<GlesApi>;
+extern template class GlesDeviceShader<GlesApi>;
+extern template class GlesDeviceVertexShader<GlesApi>;
+
+} // namespace detail
+
+extern template class BasicGlesDevice<GlesApi>;
+
 } // namespace emgui
 
 #endif // EMGUI_INCLUDE_GLES_DEVICE_HPP_
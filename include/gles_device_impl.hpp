@@ -0,0 +1,88 @@
+#ifndef EMGUI_INCLUDE_GLES_DEVICE_IMPL_HPP_
+#define EMGUI_INCLUDE_GLES_DEVICE_IMPL_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+
+#include "gles_device.hpp"
+
+namespace emgui {
+namespace detail {
+
+template <typename Gl>
+void GlesDeviceFont<Gl>::LoadDefaultFontTexImage() {
+  uint8_t *pixels = nullptr;
+  int width = 0, height = 0;
+  ImGui::GetIO().Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);
+  Gl::ActiveTexture(GL_TEXTURE0);
+  Gl::TexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA,
+      GL_UNSIGNED_BYTE, pixels);
+  ImGui::GetIO().Fonts->ClearInputData();
+  ImGui::GetIO().Fonts->ClearTexData();
+}
+
+template <typename Gl>
+GLuint GlesDeviceShader<Gl>::CreateShader(GLenum type, char const* source) const {
+  GLuint shader = Gl::CreateShader(type);
+  Gl::ShaderSource(shader, 1, &source, NULL);
+  Gl::CompileShader(shader);
+  GLint compile_status = GL_FALSE;
+  Gl::GetShaderiv(shader, GL_COMPILE_STATUS, &compile_status);
+  if (compile_status == GL_FALSE) {
+    char info_log[256];
+    Gl::GetShaderInfoLog(shader, sizeof(info_log), NULL, info_log);
+    Gl::DeleteShader(shader);
+    std::stringstream os;
+    os << "glCompileShader failed with error : " << info_log;
+    throw std::invalid_argument(os.str());
+  }
+  return shader;
+}
+
+template <typename Gl>
+void GlesDeviceVertexShader<Gl>::Enable() {
+  SetupOrthographicProjectionMatrix();
+  Gl::VertexAttribPointer(position_loc_.value(), 2, GL_FLOAT, GL_FALSE,
+      sizeof(ImDrawVert), reinterpret_cast<GLvoid const*>(offsetof(ImDrawVert, pos)));
+  Gl::VertexAttribPointer(texture_coord_loc_.value(), 2, GL_FLOAT, GL_FALSE,
+      sizeof(ImDrawVert), reinterpret_cast<GLvoid const*>(offsetof(ImDrawVert, uv)));
+  Gl::VertexAttribPointer(texture_color_loc_.value(), 4, GL_UNSIGNED_BYTE, GL_TRUE,
+      sizeof(ImDrawVert), reinterpret_cast<GLvoid const*>(offsetof(ImDrawVert, col)));
+  Gl::EnableVertexAttribArray(position_loc_.value());
+  Gl::EnableVertexAttribArray(texture_coord_loc_.value());
+  Gl::EnableVertexAttribArray(texture_color_loc_.value());
+}
+
+template <typename Gl>
+void GlesDeviceVertexShader<Gl>::SetupOrthographicProjectionMatrix() {
+  float width = std::max(ImGui::GetIO().DisplaySize.x, 1.0f);
+  float height = std::max(ImGui::GetIO().DisplaySize.y, 1.0f);
+  const float orth_proj_mat[4][4] = {
+    { 2.0f / width, 0.0f,            0.0f, 0.0f},
+    { 0.0f,         2.0f / -height,  0.0f, 0.0f},
+    { 0.0f,         0.0f,           -1.0f, 0.0f},
+    {-1.0f,         1.0f,            0.0f, 1.0f}
+  };
+  Gl::UniformMatrix4fv(proj_mat_loc_.value(), 1, GL_FALSE, &orth_proj_mat[0][0]);
+}
+
+} // namespace detail
+
+template <typename Gl>
+void BasicGlesDevice<Gl>::DrawLists(ImDrawData& draw_data) {
+  Gl::Enable(GL_BLEND);
+  Gl::BlendEquation(GL_FUNC_ADD);
+  Gl::BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+  Gl::Disable(GL_CULL_FACE);
+  Gl::Disable(GL_DEPTH_TEST);
+  Gl::Enable(GL_SCISSOR_TEST);
+  draw_data.ScaleClipRects(ImGui::GetIO().DisplayFramebufferScale);
+  program_.DrawLists(draw_data);
+  Gl::Disable(GL_SCISSOR_TEST);
+}
+
+} // namespace emgui
+
+#endif // EMGUI_INCLUDE_GLES_DEVICE_IMPL_HPP_
@@ -0,0 +1,448 @@
+#include "draw_data_codec.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+
+namespace emgui {
+namespace {
+
+constexpr uint8_t kFrameMagic = 0xE6;
+constexpr uint8_t kListReused = 0;
+constexpr uint8_t kListFull = 1;
+constexpr uint8_t kFrameKeyframe = 1;
+constexpr size_t kMaxVarintSize = 10;
+constexpr uint64_t kMaxPayloadSize = 64 * 1024 * 1024;
+
+constexpr float kPositionScale = 16.0f;
+constexpr float kTexCoordScale = 65536.0f;
+constexpr float kMaxQuantized = 1e9f;
+
+int64_t Quantize(float value, float scale) {
+  if (std::isnan(value))
+    return 0;
+  return std::llround(std::clamp(value * scale, -kMaxQuantized, kMaxQuantized));
+}
+
+float Dequantize(int64_t value, float scale) {
+  return static_cast<float>(value) / scale;
+}
+
+void WriteVarint(std::vector<uint8_t>& out, uint64_t value) {
+  while (value >= 0x80) {
+    out.push_back(static_cast<uint8_t>(value) | 0x80);
+    value >>= 7;
+  }
+  out.push_back(static_cast<uint8_t>(value));
+}
+
+void WriteSigned(std::vector<uint8_t>& out, int64_t value) {
+  WriteVarint(out, (static_cast<uint64_t>(value) << 1) ^
+      static_cast<uint64_t>(value >> 63));
+}
+
+void WriteFloat(std::vector<uint8_t>& out, float value) {
+  uint32_t bits = 0;
+  std::memcpy(&bits, &value, sizeof(bits));
+  for (int i = 0; i < 4; ++i)
+    out.push_back(static_cast<uint8_t>(bits >> (8 * i)));
+}
+
+bool SameCmd(ImDrawCmd const& lhs, ImDrawCmd const& rhs) {
+  return lhs.ElemCount == rhs.ElemCount && lhs.TextureId == rhs.TextureId &&
+      lhs.ClipRect.x == rhs.ClipRect.x && lhs.ClipRect.y == rhs.ClipRect.y &&
+      lhs.ClipRect.z == rhs.ClipRect.z && lhs.ClipRect.w == rhs.ClipRect.w;
+}
+
+template <typename T>
+bool SameBuffer(std::vector<T> const& cached, ImVector<T> const& buffer) {
+  return cached.size() == static_cast<size_t>(buffer.size()) &&
+      (cached.empty() ||
+       std::memcmp(cached.data(), buffer.Data, cached.size() * sizeof(T)) == 0);
+}
+
+template <typename T>
+void CopyToImVector(ImVector<T>& buffer, T const* data, size_t size) {
+  buffer.resize(static_cast<int>(size));
+  if (size != 0)
+    std::memcpy(buffer.Data, data, size * sizeof(T));
+}
+
+size_t RawListSize(ImDrawList const& cmd_list) {
+  return cmd_list.VtxBuffer.size() * sizeof(ImDrawVert) +
+      cmd_list.IdxBuffer.size() * sizeof(ImDrawIdx) +
+      cmd_list.CmdBuffer.size() * sizeof(ImDrawCmd);
+}
+
+} // namespace <anonymous>
+
+namespace detail {
+
+class FrameReader {
+ public:
+  FrameReader(uint8_t const* data, size_t size, size_t frame_size)
+      : data_(data), size_(size), frame_size_(frame_size) {}
+
+  bool AtEnd() const {
+    return offset_ == size_;
+  }
+
+  uint8_t ReadByte() {
+    if (offset_ == size_)
+      Fail("unexpected end of frame");
+    return data_[offset_++];
+  }
+
+  uint64_t ReadVarint() {
+    uint64_t value = 0;
+    for (unsigned shift = 0; shift < 7 * kMaxVarintSize; shift += 7) {
+      uint8_t byte = ReadByte();
+      value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+      if ((byte & 0x80) == 0)
+        return value;
+    }
+    Fail("varint is too long");
+  }
+
+  float ReadFloat() {
+    uint32_t bits = 0;
+    for (int i = 0; i < 4; ++i)
+      bits |= static_cast<uint32_t>(ReadByte()) << (8 * i);
+    float value = 0.0f;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+  }
+
+  int64_t ReadSigned() {
+    uint64_t value = ReadVarint();
+    return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+  }
+
+  int ReadCount() {
+    uint64_t count = ReadVarint();
+    if (count > size_ - offset_)
+      Fail("element count exceeds frame size");
+    return static_cast<int>(count);
+  }
+
+  [[noreturn]] void Fail(char const* reason) const {
+    std::stringstream os;
+    os << "malformed draw data frame at offset " << offset_ << " : " << reason;
+    throw DrawDataFrameError(os.str(), frame_size_);
+  }
+
+ private:
+  uint8_t const* data_;
+  size_t size_;
+  size_t frame_size_;
+  size_t offset_ = 0;
+};
+
+} // namespace detail
+
+void DrawDataEncoder::Encode(ImDrawData const& draw_data) {
+  auto start = std::chrono::steady_clock::now();
+  ++frame_;
+  stats_ = DrawDataCodecStats{};
+  stats_.lists_count = draw_data.CmdListsCount;
+  payload_.clear();
+  WriteVarint(payload_, frame_);
+  payload_.push_back(lists_.empty() ? kFrameKeyframe : 0);
+  WriteFloat(payload_, ImGui::GetIO().DisplaySize.x);
+  WriteFloat(payload_, ImGui::GetIO().DisplaySize.y);
+  WriteFloat(payload_, ImGui::GetIO().DisplayFramebufferScale.x);
+  WriteFloat(payload_, ImGui::GetIO().DisplayFramebufferScale.y);
+  WriteVarint(payload_, draw_data.CmdListsCount);
+  for (int i = 0; i < draw_data.CmdListsCount; ++i) {
+    ImDrawList const* cmd_list = draw_data.CmdLists[i];
+    auto [it, inserted] = lists_.try_emplace(cmd_list);
+    CachedList& cached = it->second;
+    if (inserted)
+      cached.id = next_list_id_++;
+    bool reused = !UpdateCachedList(cached, *cmd_list) && !inserted;
+    cached.frame = frame_;
+    WriteVarint(payload_, cached.id);
+    if (reused) {
+      payload_.push_back(kListReused);
+      ++stats_.lists_reused;
+    } else {
+      payload_.push_back(kListFull);
+      EncodeList(cached);
+      stats_.coded_raw_bytes += RawListSize(*cmd_list);
+    }
+    stats_.raw_bytes += RawListSize(*cmd_list);
+  }
+  for (auto it = lists_.begin(); it != lists_.end();) {
+    if (it->second.frame != frame_)
+      it = lists_.erase(it);
+    else
+      ++it;
+  }
+
+  std::vector<uint8_t> header{kFrameMagic};
+  WriteVarint(header, payload_.size());
+  sink_.Write(header.data(), header.size());
+  sink_.Write(payload_.data(), payload_.size());
+  stats_.encoded_bytes = header.size() + payload_.size();
+  stats_.elapsed = std::chrono::steady_clock::now() - start;
+}
+
+bool DrawDataEncoder::UpdateCachedList(CachedList& cached,
+                                       ImDrawList const& cmd_list) const {
+  bool cmds_changed = false;
+  size_t cmd_index = 0;
+  for (ImDrawCmd const& cmd : cmd_list.CmdBuffer) {
+    if (cmd.UserCallback)
+      continue;
+    if (cmd_index >= cached.cmd_buffer.size() ||
+        !SameCmd(cached.cmd_buffer[cmd_index], cmd))
+      cmds_changed = true;
+    ++cmd_index;
+  }
+  cmds_changed = cmds_changed || cmd_index != cached.cmd_buffer.size();
+  bool vtx_changed = !SameBuffer(cached.vtx_buffer, cmd_list.VtxBuffer);
+  bool idx_changed = !SameBuffer(cached.idx_buffer, cmd_list.IdxBuffer);
+  if (!cmds_changed && !vtx_changed && !idx_changed)
+    return false;
+
+  cached.cmd_buffer.clear();
+  for (ImDrawCmd const& cmd : cmd_list.CmdBuffer) {
+    if (!cmd.UserCallback)
+      cached.cmd_buffer.push_back(cmd);
+  }
+  cached.vtx_buffer.assign(cmd_list.VtxBuffer.begin(), cmd_list.VtxBuffer.end());
+  cached.idx_buffer.assign(cmd_list.IdxBuffer.begin(), cmd_list.IdxBuffer.end());
+  return true;
+}
+
+void DrawDataEncoder::EncodeList(CachedList const& cached) {
+  WriteVarint(payload_, cached.vtx_buffer.size());
+  int64_t prev_pos[2] = {0, 0};
+  int64_t prev_uv[2] = {0, 0};
+  ImU32 prev_col = 0;
+  for (ImDrawVert const& vtx : cached.vtx_buffer) {
+    int64_t pos[2] = {Quantize(vtx.pos.x, kPositionScale),
+                      Quantize(vtx.pos.y, kPositionScale)};
+    int64_t uv[2] = {Quantize(vtx.uv.x, kTexCoordScale),
+                     Quantize(vtx.uv.y, kTexCoordScale)};
+    for (int axis = 0; axis < 2; ++axis) {
+      WriteSigned(payload_, pos[axis] - prev_pos[axis]);
+      WriteSigned(payload_, uv[axis] - prev_uv[axis]);
+      prev_pos[axis] = pos[axis];
+      prev_uv[axis] = uv[axis];
+    }
+    WriteVarint(payload_, vtx.col ^ prev_col);
+    prev_col = vtx.col;
+  }
+
+  WriteVarint(payload_, cached.idx_buffer.size());
+  int64_t prev_idx = 0;
+  for (ImDrawIdx idx : cached.idx_buffer) {
+    WriteSigned(payload_, static_cast<int64_t>(idx) - prev_idx);
+    prev_idx = idx;
+  }
+
+  WriteVarint(payload_, cached.cmd_buffer.size());
+  int64_t prev_clip[4] = {0, 0, 0, 0};
+  for (ImDrawCmd const& cmd : cached.cmd_buffer) {
+    WriteVarint(payload_, cmd.ElemCount);
+    WriteVarint(payload_, reinterpret_cast<std::uintptr_t>(cmd.TextureId));
+    int64_t clip[4] = {Quantize(cmd.ClipRect.x, kPositionScale),
+                       Quantize(cmd.ClipRect.y, kPositionScale),
+                       Quantize(cmd.ClipRect.z, kPositionScale),
+                       Quantize(cmd.ClipRect.w, kPositionScale)};
+    for (int i = 0; i < 4; ++i) {
+      WriteSigned(payload_, clip[i] - prev_clip[i]);
+      prev_clip[i] = clip[i];
+    }
+  }
+}
+
+size_t DrawDataDecoder::Decode(uint8_t const* data, size_t size) {
+  if (size == 0)
+    return 0;
+  if (data[0] != kFrameMagic)
+    detail::FrameReader(data, size, 1).Fail("bad frame magic");
+  uint64_t payload_size = 0;
+  size_t header_size = 1;
+  for (unsigned shift = 0;; shift += 7, ++header_size) {
+    if (header_size == size)
+      return 0;
+    if (header_size > kMaxVarintSize)
+      detail::FrameReader(data, size, 1).Fail("frame size varint is too long");
+    uint8_t byte = data[header_size];
+    payload_size |= static_cast<uint64_t>(byte & 0x7F) << shift;
+    if ((byte & 0x80) == 0) {
+      ++header_size;
+      break;
+    }
+  }
+  if (payload_size > kMaxPayloadSize)
+    detail::FrameReader(data, size, 1).Fail("frame size exceeds limit");
+  if (payload_size > size - header_size)
+    return 0;
+
+  auto start = std::chrono::steady_clock::now();
+  for (PendingList& pending : pending_lists_) {
+    if (pending.decoded)
+      spare_lists_.push_back(std::move(pending.decoded));
+  }
+  pending_lists_.clear();
+  detail::FrameReader reader(data + header_size, payload_size,
+      header_size + payload_size);
+  uint32_t sequence = static_cast<uint32_t>(reader.ReadVarint());
+  bool keyframe = (reader.ReadByte() & kFrameKeyframe) != 0;
+  if (!keyframe && (!has_sequence_ || sequence != sequence_ + 1))
+    reader.Fail("frame is out of sequence, a keyframe is required");
+  ImVec2 display_size;
+  display_size.x = reader.ReadFloat();
+  display_size.y = reader.ReadFloat();
+  ImVec2 display_framebuffer_scale;
+  display_framebuffer_scale.x = reader.ReadFloat();
+  display_framebuffer_scale.y = reader.ReadFloat();
+  int lists_count = reader.ReadCount();
+  int lists_reused = 0;
+  for (int i = 0; i < lists_count; ++i) {
+    PendingList pending;
+    pending.id = static_cast<uint32_t>(reader.ReadVarint());
+    uint8_t kind = reader.ReadByte();
+    if (kind == kListReused) {
+      if (!HasList(pending.id))
+        reader.Fail("reference to unknown draw list");
+      ++lists_reused;
+    } else if (kind == kListFull) {
+      pending.decoded = AcquireList();
+      DecodeList(reader, *pending.decoded);
+    } else {
+      reader.Fail("unknown draw list kind");
+    }
+    pending_lists_.push_back(std::move(pending));
+  }
+  if (!reader.AtEnd())
+    reader.Fail("trailing bytes after last draw list");
+
+  ++frame_;
+  has_sequence_ = true;
+  sequence_ = sequence;
+  cmd_lists_.clear();
+  size_t coded_raw_bytes = 0;
+  for (PendingList& pending : pending_lists_) {
+    std::unique_ptr<DecodedList>& decoded = lists_[pending.id];
+    bool coded = pending.decoded != nullptr;
+    if (coded) {
+      if (decoded)
+        spare_lists_.push_back(std::move(decoded));
+      decoded = std::move(pending.decoded);
+    }
+    decoded->frame = frame_;
+    CopyToImVector(decoded->cmd_list.CmdBuffer, decoded->cmd_buffer.data(),
+        decoded->cmd_buffer.size());
+    if (coded)
+      coded_raw_bytes += RawListSize(decoded->cmd_list);
+    cmd_lists_.push_back(&decoded->cmd_list);
+  }
+  pending_lists_.clear();
+  for (auto it = lists_.begin(); it != lists_.end();) {
+    if (it->second->frame != frame_) {
+      spare_lists_.push_back(std::move(it->second));
+      it = lists_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+
+  display_size_ = display_size;
+  display_framebuffer_scale_ = display_framebuffer_scale;
+  draw_data_.Valid = true;
+  draw_data_.CmdLists = cmd_lists_.data();
+  draw_data_.CmdListsCount = static_cast<int>(cmd_lists_.size());
+  draw_data_.TotalVtxCount = 0;
+  draw_data_.TotalIdxCount = 0;
+  stats_ = DrawDataCodecStats{};
+  for (ImDrawList const* cmd_list : cmd_lists_) {
+    draw_data_.TotalVtxCount += cmd_list->VtxBuffer.size();
+    draw_data_.TotalIdxCount += cmd_list->IdxBuffer.size();
+    stats_.raw_bytes += RawListSize(*cmd_list);
+  }
+  stats_.coded_raw_bytes = coded_raw_bytes;
+  stats_.encoded_bytes = header_size + payload_size;
+  stats_.lists_count = draw_data_.CmdListsCount;
+  stats_.lists_reused = lists_reused;
+  stats_.elapsed = std::chrono::steady_clock::now() - start;
+  return header_size + payload_size;
+}
+
+void DrawDataDecoder::DecodeList(detail::FrameReader& reader,
+                                 DecodedList& decoded) const {
+  ImDrawList& cmd_list = decoded.cmd_list;
+  int vtx_count = reader.ReadCount();
+  cmd_list.VtxBuffer.resize(vtx_count);
+  int64_t pos[2] = {0, 0};
+  int64_t uv[2] = {0, 0};
+  ImU32 col = 0;
+  for (ImDrawVert& vtx : cmd_list.VtxBuffer) {
+    for (int axis = 0; axis < 2; ++axis) {
+      pos[axis] += reader.ReadSigned();
+      uv[axis] += reader.ReadSigned();
+    }
+    col ^= static_cast<ImU32>(reader.ReadVarint());
+    vtx.pos = ImVec2(Dequantize(pos[0], kPositionScale),
+                     Dequantize(pos[1], kPositionScale));
+    vtx.uv = ImVec2(Dequantize(uv[0], kTexCoordScale),
+                    Dequantize(uv[1], kTexCoordScale));
+    vtx.col = col;
+  }
+
+  int idx_count = reader.ReadCount();
+  cmd_list.IdxBuffer.resize(idx_count);
+  int64_t idx = 0;
+  for (ImDrawIdx& value : cmd_list.IdxBuffer) {
+    idx += reader.ReadSigned();
+    if (idx < 0 || idx >= vtx_count)
+      reader.Fail("index is out of vertex buffer range");
+    value = static_cast<ImDrawIdx>(idx);
+  }
+
+  int cmd_count = reader.ReadCount();
+  decoded.cmd_buffer.resize(cmd_count);
+  int64_t clip[4] = {0, 0, 0, 0};
+  uint64_t elem_count_total = 0;
+  for (ImDrawCmd& cmd : decoded.cmd_buffer) {
+    cmd = ImDrawCmd();
+    cmd.ElemCount = static_cast<unsigned int>(reader.ReadVarint());
+    ImTextureID texture_id = reinterpret_cast<ImTextureID>(
+        static_cast<std::uintptr_t>(reader.ReadVarint()));
+    auto mapped = texture_map_.find(texture_id);
+    cmd.TextureId = mapped != texture_map_.end() ? mapped->second : texture_id;
+    for (int i = 0; i < 4; ++i)
+      clip[i] += reader.ReadSigned();
+    cmd.ClipRect = ImVec4(Dequantize(clip[0], kPositionScale),
+                          Dequantize(clip[1], kPositionScale),
+                          Dequantize(clip[2], kPositionScale),
+                          Dequantize(clip[3], kPositionScale));
+    elem_count_total += cmd.ElemCount;
+  }
+  if (elem_count_total > static_cast<uint64_t>(idx_count))
+    reader.Fail("draw commands exceed index buffer size");
+}
+
+bool DrawDataDecoder::HasList(uint32_t id) const {
+  if (lists_.count(id) != 0)
+    return true;
+  return std::any_of(pending_lists_.begin(), pending_lists_.end(),
+      [id](PendingList const& pending) {
+        return pending.id == id && pending.decoded;
+      });
+}
+
+std::unique_ptr<DrawDataDecoder::DecodedList> DrawDataDecoder::AcquireList() {
+  if (spare_lists_.empty())
+    return std::make_unique<DecodedList>();
+  std::unique_ptr<DecodedList> decoded = std::move(spare_lists_.back());
+  spare_lists_.pop_back();
+  return decoded;
+}
+
+} // namespace emgui
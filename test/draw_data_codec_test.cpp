@@ -0,0 +1,308 @@
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <stdexcept>
+#include <vector>
+
+#include "imgui.h"
+
+#include "draw_data_codec.hpp"
+
+namespace {
+
+int failures = 0;
+
+#define CHECK(condition)                                                  \
+  do {                                                                    \
+    if (!(condition)) {                                                   \
+      std::fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__,         \
+          __LINE__, #condition);                                          \
+      ++failures;                                                         \
+    }                                                                     \
+  } while (false)
+
+void FillList(ImDrawList& cmd_list, float offset, ImTextureID texture_id) {
+  for (int i = 0; i < 300; ++i) {
+    ImDrawVert vtx;
+    vtx.pos = ImVec2(offset + i * 0.5f, 100.25f);
+    vtx.uv = ImVec2(0.25f, 0.5f);
+    vtx.col = 0xFF00FF00 + i;
+    cmd_list.VtxBuffer.push_back(vtx);
+  }
+  for (int i = 0; i < 450; ++i)
+    cmd_list.IdxBuffer.push_back(static_cast<ImDrawIdx>((i * 7) % 300));
+  ImDrawCmd cmd;
+  cmd.ClipRect = ImVec4(0.0f, 0.0f, 800.0f, 600.0f);
+  cmd.TextureId = texture_id;
+  for (unsigned int elem_count : {150, 150, 150}) {
+    cmd.ElemCount = elem_count;
+    cmd_list.CmdBuffer.push_back(cmd);
+  }
+}
+
+bool SameList(ImDrawList const& lhs, ImDrawList const& rhs) {
+  if (lhs.VtxBuffer.size() != rhs.VtxBuffer.size() ||
+      lhs.IdxBuffer.size() != rhs.IdxBuffer.size() ||
+      lhs.CmdBuffer.size() != rhs.CmdBuffer.size())
+    return false;
+  for (int i = 0; i < lhs.VtxBuffer.size(); ++i) {
+    ImDrawVert const& l = lhs.VtxBuffer[i];
+    ImDrawVert const& r = rhs.VtxBuffer[i];
+    if (l.pos.x != r.pos.x || l.pos.y != r.pos.y || l.uv.x != r.uv.x ||
+        l.uv.y != r.uv.y || l.col != r.col)
+      return false;
+  }
+  for (int i = 0; i < lhs.IdxBuffer.size(); ++i) {
+    if (lhs.IdxBuffer[i] != rhs.IdxBuffer[i])
+      return false;
+  }
+  for (int i = 0; i < lhs.CmdBuffer.size(); ++i) {
+    ImDrawCmd const& l = lhs.CmdBuffer[i];
+    ImDrawCmd const& r = rhs.CmdBuffer[i];
+    if (l.ElemCount != r.ElemCount || l.ClipRect.x != r.ClipRect.x ||
+        l.ClipRect.y != r.ClipRect.y || l.ClipRect.z != r.ClipRect.z ||
+        l.ClipRect.w != r.ClipRect.w)
+      return false;
+  }
+  return true;
+}
+
+class CodecFixture {
+ public:
+  CodecFixture() : encoder_(sink_) {
+    FillList(first_, 0.0f, texture_);
+    FillList(second_, 10.0f, texture_);
+  }
+
+  ImDrawData& Frame(int lists_count) {
+    cmd_lists_[0] = &first_;
+    cmd_lists_[1] = &second_;
+    draw_data_.Valid = true;
+    draw_data_.CmdLists = cmd_lists_;
+    draw_data_.CmdListsCount = lists_count;
+    return draw_data_;
+  }
+
+  ImDrawData& RoundTrip(int lists_count) {
+    encoder_.Encode(Frame(lists_count));
+    size_t consumed = decoder_.Decode(sink_.Data(), sink_.Size());
+    CHECK(consumed == sink_.Size());
+    sink_.Consume(consumed);
+    return decoder_.DrawData();
+  }
+
+  ImTextureID const texture_ = reinterpret_cast<ImTextureID>(
+      static_cast<std::uintptr_t>(7));
+  ImDrawList first_;
+  ImDrawList second_;
+  ImDrawList* cmd_lists_[2] = {nullptr, nullptr};
+  ImDrawData draw_data_;
+  emgui::BufferByteSink sink_;
+  emgui::DrawDataEncoder encoder_;
+  emgui::DrawDataDecoder decoder_;
+};
+
+void TestUnchangedListsAreReused() {
+  CodecFixture codec;
+  ImDrawData& first_frame = codec.RoundTrip(2);
+  CHECK(codec.encoder_.LastFrameStats().lists_reused == 0);
+  CHECK(first_frame.CmdListsCount == 2);
+  CHECK(SameList(*first_frame.CmdLists[0], codec.first_));
+  CHECK(SameList(*first_frame.CmdLists[1], codec.second_));
+  size_t full_frame_bytes = codec.encoder_.LastFrameStats().encoded_bytes;
+
+  ImDrawData& second_frame = codec.RoundTrip(2);
+  CHECK(codec.encoder_.LastFrameStats().lists_reused == 2);
+  CHECK(codec.decoder_.LastFrameStats().lists_reused == 2);
+  CHECK(codec.encoder_.LastFrameStats().encoded_bytes < 32);
+  CHECK(codec.encoder_.LastFrameStats().encoded_bytes < full_frame_bytes);
+  CHECK(SameList(*second_frame.CmdLists[0], codec.first_));
+  CHECK(SameList(*second_frame.CmdLists[1], codec.second_));
+  CHECK(second_frame.TotalVtxCount == 600);
+  CHECK(second_frame.TotalIdxCount == 900);
+}
+
+void TestChangedVertexReencodesOnlyItsList() {
+  CodecFixture codec;
+  codec.RoundTrip(2);
+  codec.second_.VtxBuffer[5].pos.x = 77.0f;
+  ImDrawData& frame = codec.RoundTrip(2);
+  CHECK(codec.encoder_.LastFrameStats().lists_reused == 1);
+  CHECK(codec.decoder_.LastFrameStats().lists_reused == 1);
+  CHECK(frame.CmdLists[1]->VtxBuffer[5].pos.x == 77.0f);
+  CHECK(SameList(*frame.CmdLists[0], codec.first_));
+  CHECK(SameList(*frame.CmdLists[1], codec.second_));
+}
+
+void TestDroppedListIsResent() {
+  CodecFixture codec;
+  codec.RoundTrip(2);
+  ImDrawData& dropped = codec.RoundTrip(1);
+  CHECK(dropped.CmdListsCount == 1);
+  CHECK(codec.encoder_.LastFrameStats().lists_reused == 1);
+  ImDrawData& restored = codec.RoundTrip(2);
+  CHECK(restored.CmdListsCount == 2);
+  CHECK(codec.encoder_.LastFrameStats().lists_reused == 1);
+  CHECK(SameList(*restored.CmdLists[1], codec.second_));
+}
+
+void TestPartialBufferIsNotConsumed() {
+  CodecFixture codec;
+  codec.encoder_.Encode(codec.Frame(2));
+  for (size_t size = 0; size < codec.sink_.Size(); size += 97)
+    CHECK(codec.decoder_.Decode(codec.sink_.Data(), size) == 0);
+  CHECK(codec.decoder_.Decode(codec.sink_.Data(), codec.sink_.Size()) ==
+      codec.sink_.Size());
+}
+
+void TestClipRectsAreRestored() {
+  CodecFixture codec;
+  ImDrawData& first_frame = codec.RoundTrip(2);
+  first_frame.CmdLists[0]->CmdBuffer[0].ClipRect.z = 5.0f;
+  ImDrawData& second_frame = codec.RoundTrip(2);
+  CHECK(codec.decoder_.LastFrameStats().lists_reused == 2);
+  CHECK(second_frame.CmdLists[0]->CmdBuffer[0].ClipRect.z == 800.0f);
+}
+
+void TestMalformedFrameThrows() {
+  CodecFixture codec;
+  codec.RoundTrip(2);
+  codec.second_.VtxBuffer[0].col = 0;
+  codec.encoder_.Encode(codec.Frame(2));
+  std::vector<uint8_t> corrupted(codec.sink_.Data(),
+      codec.sink_.Data() + codec.sink_.Size());
+  corrupted.back() = 0x80;
+  bool thrown = false;
+  try {
+    codec.decoder_.Decode(corrupted.data(), corrupted.size());
+  } catch (std::invalid_argument const&) {
+    thrown = true;
+  }
+  CHECK(thrown);
+
+  ImDrawData& previous = codec.decoder_.DrawData();
+  CHECK(previous.CmdListsCount == 2);
+  CHECK(previous.CmdLists[1]->VtxBuffer[0].col == 0xFF00FF00);
+  CHECK(codec.decoder_.Decode(codec.sink_.Data(), codec.sink_.Size()) ==
+      codec.sink_.Size());
+  CHECK(SameList(*codec.decoder_.DrawData().CmdLists[1], codec.second_));
+
+  uint8_t const bad_magic[] = {0x00, 0x01, 0x00};
+  thrown = false;
+  try {
+    codec.decoder_.Decode(bad_magic, sizeof(bad_magic));
+  } catch (std::invalid_argument const&) {
+    thrown = true;
+  }
+  CHECK(thrown);
+}
+
+size_t DecodeError(emgui::DrawDataDecoder& decoder, uint8_t const* data,
+                   size_t size) {
+  try {
+    decoder.Decode(data, size);
+  } catch (emgui::DrawDataFrameError const& error) {
+    return error.FrameSize();
+  }
+  return 0;
+}
+
+void TestLateJoinWaitsForKeyframe() {
+  CodecFixture codec;
+  codec.encoder_.Encode(codec.Frame(2));
+  codec.sink_.Consume(codec.sink_.Size());
+
+  emgui::DrawDataDecoder late_decoder;
+  codec.encoder_.Encode(codec.Frame(2));
+  size_t frame_size = codec.sink_.Size();
+  CHECK(DecodeError(late_decoder, codec.sink_.Data(), codec.sink_.Size()) ==
+      frame_size);
+  codec.sink_.Consume(frame_size);
+
+  codec.encoder_.Reset();
+  codec.encoder_.Encode(codec.Frame(2));
+  CHECK(codec.encoder_.LastFrameStats().lists_reused == 0);
+  CHECK(late_decoder.Decode(codec.sink_.Data(), codec.sink_.Size()) ==
+      codec.sink_.Size());
+  codec.sink_.Consume(codec.sink_.Size());
+  CHECK(late_decoder.DrawData().CmdListsCount == 2);
+  CHECK(SameList(*late_decoder.DrawData().CmdLists[0], codec.first_));
+  CHECK(SameList(*late_decoder.DrawData().CmdLists[1], codec.second_));
+}
+
+void TestRecoversAfterCorruptedFrame() {
+  CodecFixture codec;
+  codec.RoundTrip(2);
+  codec.second_.VtxBuffer[0].col = 0;
+  codec.encoder_.Encode(codec.Frame(2));
+  size_t corrupted_size = codec.sink_.Size();
+  codec.encoder_.Encode(codec.Frame(2));
+  std::vector<uint8_t> stream(codec.sink_.Data(),
+      codec.sink_.Data() + codec.sink_.Size());
+  codec.sink_.Consume(codec.sink_.Size());
+  stream[corrupted_size - 1] = 0x80;
+
+  size_t skipped = DecodeError(codec.decoder_, stream.data(), stream.size());
+  CHECK(skipped == corrupted_size);
+  size_t next_size = stream.size() - skipped;
+  CHECK(DecodeError(codec.decoder_, stream.data() + skipped, next_size) ==
+      next_size);
+  CHECK(codec.decoder_.DrawData().CmdLists[1]->VtxBuffer[0].col == 0xFF00FF00);
+
+  codec.encoder_.Reset();
+  ImDrawData& recovered = codec.RoundTrip(2);
+  CHECK(SameList(*recovered.CmdLists[0], codec.first_));
+  CHECK(SameList(*recovered.CmdLists[1], codec.second_));
+  CHECK(codec.RoundTrip(2).CmdListsCount == 2);
+  CHECK(codec.decoder_.LastFrameStats().lists_reused == 2);
+}
+
+void TestOversizedFrameThrows() {
+  emgui::DrawDataDecoder decoder;
+  uint8_t const oversized[] = {0xE6, 0xFF, 0xFF, 0xFF, 0xFF, 0x0F, 0x00};
+  CHECK(DecodeError(decoder, oversized, sizeof(oversized)) == 1);
+}
+
+void TestNonFiniteCoordinates() {
+  CodecFixture codec;
+  codec.first_.VtxBuffer[0].pos.x = std::nanf("");
+  codec.first_.VtxBuffer[1].pos.x = INFINITY;
+  ImDrawData& frame = codec.RoundTrip(1);
+  CHECK(frame.CmdLists[0]->VtxBuffer[0].pos.x == 0.0f);
+  CHECK(std::isfinite(frame.CmdLists[0]->VtxBuffer[1].pos.x));
+  CHECK(frame.CmdLists[0]->VtxBuffer[2].pos.x == 1.0f);
+}
+
+void TestDisplayAndTextureMapping() {
+  CodecFixture codec;
+  ImGui::GetIO().DisplaySize = ImVec2(1280.0f, 720.0f);
+  ImGui::GetIO().DisplayFramebufferScale = ImVec2(2.0f, 2.0f);
+  ImTextureID local = reinterpret_cast<ImTextureID>(
+      static_cast<std::uintptr_t>(42));
+  codec.decoder_.MapTexture(codec.texture_, local);
+  ImDrawData& frame = codec.RoundTrip(1);
+  CHECK(codec.decoder_.DisplaySize().x == 1280.0f);
+  CHECK(codec.decoder_.DisplaySize().y == 720.0f);
+  CHECK(codec.decoder_.DisplayFramebufferScale().x == 2.0f);
+  CHECK(frame.CmdLists[0]->CmdBuffer[0].TextureId == local);
+}
+
+} // namespace <anonymous>
+
+int main()
+{
+  TestUnchangedListsAreReused();
+  TestChangedVertexReencodesOnlyItsList();
+  TestDroppedListIsResent();
+  TestPartialBufferIsNotConsumed();
+  TestClipRectsAreRestored();
+  TestMalformedFrameThrows();
+  TestLateJoinWaitsForKeyframe();
+  TestRecoversAfterCorruptedFrame();
+  TestOversizedFrameThrows();
+  TestNonFiniteCoordinates();
+  TestDisplayAndTextureMapping();
+  if (failures != 0)
+    std::fprintf(stderr, "%d checks failed\n", failures);
+  return failures == 0 ? 0 : 1;
+}